@@ -10,14 +10,16 @@
 
 #define _DEFAULT_SOURCE
 #include <ncurses.h>       // Required for curses functions
-#include <unistd.h>        // Required for usleep
 #include <stdio.h>         // For macros and standard input/output
 #include <stdlib.h>        // For other macros and standard library functions
+#include <string.h>        // For comparing option strings
 #include <time.h>          // For randomized time
 #include <getopt.h>        // Required to process for "-flag" command 
                            // line arguments
 #include "grid.h"          // For initializing grid for simulation
 #include "agent.h"         // For agent information 
+#include "view.h"          // For zoomable ncurses display
+#include "frame.h"         // For buffered print mode output
 
 /**
  * Helper method usage_help() displays the proper usage command example for
@@ -27,7 +29,7 @@
  * @return void: Returns nothing
  */
 void usage_help() {
-    fprintf( stderr, "usage:\nbracetopia [-h] [-t N] [-c N] [-d dim] [-s %%str] [-v %%vac] [-e %%end]\n" );
+    fprintf( stderr, "usage:\nbracetopia [-h] [-t N] [-c N] [-d dim] [-s %%str] [-v %%vac] [-e %%end] [--format fmt]\n" );
 }
 
 /**
@@ -39,14 +41,44 @@ void usage_help() {
  * @return void: Returns nothing
  */
 void display_commands() {
-    printf("Option      Default   Example   Description\n");
-    printf("'-h'        NA        -h        print this usage message.\n");
-    printf("'-t N'      900000    -t 5000   microseconds cycle delay.\n");
-    printf("'-c N'      NA        -c4       count cycle maximum value.\n");
-    printf("'-d dim'    15        -d 7      width and height dimension.\n");
-    printf("'-s %%str'   50        -s 30     strength of preference.\n");
-    printf("'-v %%vac'   20        -v30      percent vacancies.\n");
-    printf("'-e %%endl'  60        -e75      percent Endline braces. Others want Newline.\n");
+    printf("Option      Default   Example       Description\n");
+    printf("'-h'        NA        -h            print this usage message.\n");
+    printf("'-t N'      900000    -t 5000       microseconds cycle delay.\n");
+    printf("'-c N'      NA        -c4           count cycle maximum value.\n");
+    printf("'-d dim'    15        -d 7          width and height dimension.\n");
+    printf("'-s %%str'   50        -s 30         strength of preference.\n");
+    printf("'-v %%vac'   20        -v30          percent vacancies.\n");
+    printf("'-e %%endl'  60        -e75          percent Endline braces. Others want Newline.\n");
+    printf("'--format'  text      --format pgm  print mode output: text, pgm frames, or none.\n");
+}
+
+/**
+ * Helper method current_microseconds() reads the monotonic clock, used to
+ * schedule simulation steps in the ncurses display.
+ * 
+ * @param void: Accepts no parameters
+ * @return long long: Current time in microseconds
+ */
+long long current_microseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((long long) now.tv_sec * 1000000) + (now.tv_nsec / 1000);
+}
+
+/**
+ * Helper method update_view() is the relocation callback for move_grid that
+ * keeps the view's block counts in step with the grid.
+ * 
+ * @param from: Integer location the agent left within the 1d grid
+ * @param to: Integer location the agent moved to within the 1d grid
+ * @param agent: Character of the agent that moved
+ * @param context: Pointer to the pyramid being updated
+ * @return void: Returns nothing
+ */
+void update_view(int from, int to, char agent, void *context) {
+    Pyramid *pyramid = context;
+    pyramid_update(pyramid, from, agent, '.');
+    pyramid_update(pyramid, to, '.', agent);
 }
 
 /**
@@ -65,6 +97,8 @@ int main(int argc, char * argv[]) {
     int strength = 50;
     int time = 900000;
     int temp;
+    enum { FORMAT_TEXT, FORMAT_PGM, FORMAT_NONE } format = FORMAT_TEXT;
+    const int MAX_DIMENSION = 4096;
 
     // Initialize other variables for output
     int cycle_counter = 0;
@@ -73,9 +107,13 @@ int main(int argc, char * argv[]) {
     double team_happiness = 0.00;
     double *team_happiness_ptr = &team_happiness;
     int opt;
+    const struct option long_options[] = {
+        { "format", required_argument, NULL, 'f' },
+        { NULL, 0, NULL, 0 }
+    };
 
     // Parse command line arguments for relevant grid data
-    while ((opt = getopt(argc, argv, "ht:c:d:s:v:e:")) != -1) {
+    while ((opt = getopt_long(argc, argv, "ht:c:d:s:v:e:", long_options, NULL)) != -1) {
         switch (opt) {
         case 'h':
             usage_help();
@@ -98,8 +136,8 @@ int main(int argc, char * argv[]) {
             break;
         case 'd':
             side_length = (int) strtol(optarg, NULL, 10);
-            if (side_length < 5 || side_length > 39) {
-                fprintf(stderr, "dimension (%i) must be a value in [5...39]\n", side_length);
+            if (side_length < 5 || side_length > MAX_DIMENSION) {
+                fprintf(stderr, "dimension (%i) must be a value in [5...%d]\n", side_length, MAX_DIMENSION);
                 usage_help();
                 return (1 + EXIT_FAILURE);                
             }
@@ -128,71 +166,166 @@ int main(int argc, char * argv[]) {
                 return (1 + EXIT_FAILURE);                
             }
             break;
+        case 'f':
+            if (strcmp(optarg, "text") == 0) {
+                format = FORMAT_TEXT;
+            }
+            else if (strcmp(optarg, "pgm") == 0) {
+                format = FORMAT_PGM;
+            }
+            else if (strcmp(optarg, "none") == 0) {
+                format = FORMAT_NONE;
+            }
+            else {
+                fprintf(stderr, "format (%s) must be one of text, pgm, or none\n", optarg);
+                usage_help();
+                return (1 + EXIT_FAILURE);
+            }
+            break;
         default:
             usage_help();
             return (EXIT_FAILURE);
         }
     }
 
-    // Initialize grid data
-    char grid[side_length * side_length];
+    // Initialize grid data and the scratch copy used when moving agents
+    // (heap allocated since large grids do not fit on the stack)
+    char *grid = malloc((size_t) side_length * side_length);
+    char *copy = malloc((size_t) side_length * side_length);
+    if (grid == NULL || copy == NULL) {
+        fprintf(stderr, "unable to allocate grid of dimension %i\n", side_length);
+        free(grid);
+        free(copy);
+        return (EXIT_FAILURE);
+    }
     initialize_grid(grid, side_length, vacancy, endlines);
 
     // Identify count option or curse option
     if (count != -1) {
+        // Reuse one frame buffer so each cycle is sent with a single write
+        FrameBuffer frame = { NULL, 0, 0 };
+
         for (int i = -1; i < count; i++) {
-            // Calculate information for next grid
-            calculate_team_happiness(grid, side_length, team_happiness_ptr);
+            int status = 0;
 
-            // Display current board
-            output_print_grid(grid, side_length);
+            if (format == FORMAT_PGM) {
+                // Display current board as an image frame
+                status = output_pgm_grid(&frame, grid, side_length);
+            }
+            else {
+                // Calculate information for next grid
+                calculate_team_happiness(grid, side_length, team_happiness_ptr);
 
-            // Display cycle information
-            printf("\ncycle: %i\n", (i + 1));
-            printf("moves this cycle: %d\n", *move_counter_ptr);
-            printf("teams' \"happiness\": %f\n", *team_happiness_ptr);
-            printf("dim: %d, %%strength of preference:  %d%%, %%vacancy:  %d%%, %%end:  %d%%", side_length, strength, vacancy, endlines);
+                // Display current board
+                if (format == FORMAT_TEXT) {
+                    status = output_print_grid(&frame, grid, side_length);
+                }
+
+                // Display cycle information
+                if (status == 0 && frame_printf(&frame, "\ncycle: %i\n"
+                        "moves this cycle: %d\n"
+                        "teams' \"happiness\": %f\n"
+                        "dim: %d, %%strength of preference:  %d%%, %%vacancy:  %d%%, %%end:  %d%%",
+                        (i + 1), *move_counter_ptr, *team_happiness_ptr,
+                        side_length, strength, vacancy, endlines) < 0) {
+                    status = -1;
+                }
+            }
+
+            // Only send complete frames
+            if (status != 0 || frame_flush(&frame, stdout) != 0) {
+                fprintf(stderr, "unable to write cycle %i\n", (i + 1));
+                frame_free(&frame);
+                free(grid);
+                free(copy);
+                return (EXIT_FAILURE);
+            }
 
             // Update grid and team happiness by moving agents
-            move_grid(grid, side_length, strength, move_counter_ptr);
+            move_grid(grid, copy, side_length, strength, move_counter_ptr, NULL, NULL);
         }
 
-        printf("\n");
+        if (format != FORMAT_PGM) {
+            printf("\n");
+        }
+        frame_free(&frame);
     }
     else {
+        // Build block counts for zoomed out views
+        Pyramid *pyramid = pyramid_create(grid, side_length);
+        if (pyramid == NULL) {
+            fprintf(stderr, "unable to allocate view of dimension %i\n", side_length);
+            free(grid);
+            free(copy);
+            return (EXIT_FAILURE);
+        }
+        Viewport view;
+
         // Initialize screen from ncurses
         initscr();
+        cbreak();
+        noecho();
+        keypad(stdscr, TRUE);
+        curs_set(0);
         refresh();
 
-        // Cycle endlessly through generations
-        while(1) {
-            move(0, 0);
-            
+        // Leave the first row blank and five rows for cycle information
+        int view_rows = (LINES - 6 > 1) ? (LINES - 6) : 1;
+        int view_cols = (COLS > 2) ? COLS : 2;
+        view_fit(&view, pyramid, view_rows, view_cols);
+
+        // Cycle through generations until quit, stepping once per cycle delay
+        // whether or not keys are being pressed
+        long long next_step = current_microseconds() + time;
+        int key = 0;
+        while (key != 'q') {
+            erase();
+
             // Display current board
-            output_ngrid(grid, side_length);
+            int shown_rows = output_nview(&view, pyramid, view_rows, view_cols);
 
             // Display cycle information
-            mvprintw(side_length + 1, 0, "cycle: %d\n", cycle_counter);
-            mvprintw(side_length + 2, 0, "moves this cycle: %d\n", *move_counter_ptr);
-            mvprintw(side_length + 3, 0, "teams' \"happiness\": %f\n", *team_happiness_ptr);
-            mvprintw(side_length + 4, 0, "dim: %d, %%strength of preference:  %d%%, %%vacancy:  %d%%, %%end:  %d%%\n", side_length, strength, vacancy, endlines);
-            mvprintw(side_length + 5, 0, "Use Control-C to quit.\n");
-            cycle_counter++;
+            mvprintw(shown_rows + 1, 0, "cycle: %d\n", cycle_counter);
+            mvprintw(shown_rows + 2, 0, "moves this cycle: %d\n", *move_counter_ptr);
+            mvprintw(shown_rows + 3, 0, "teams' \"happiness\": %f\n", *team_happiness_ptr);
+            mvprintw(shown_rows + 4, 0, "dim: %d, %%strength of preference:  %d%%, %%vacancy:  %d%%, %%end:  %d%%\n", side_length, strength, vacancy, endlines);
+            mvprintw(shown_rows + 5, 0, "zoom: 1:%d. Arrows/hjkl to pan, +/- to zoom, q to quit.\n", 1 << view.zoom);
             
             // Update and refresh board per new generation
-            move(side_length, 0);
             refresh();
 
-            // Update grid and team happiness by moving agents
-            move_grid(grid, side_length, strength, move_counter_ptr);
-            calculate_team_happiness(grid, side_length, team_happiness_ptr);
+            // Wait for a key press for at most the time left until the next step
+            long long remaining = next_step - current_microseconds();
+            timeout((remaining > 0) ? (int) (remaining / 1000) : 0);
+            key = getch();
+            if (key == KEY_RESIZE) {
+                view_rows = (LINES - 6 > 1) ? (LINES - 6) : 1;
+                view_cols = (COLS > 2) ? COLS : 2;
+            }
+            if (key != ERR) {
+                view_handle_key(&view, pyramid, key, view_rows, view_cols);
+            }
 
-            // Delay cycles with sleep time
-            usleep(time);
+            long long now = current_microseconds();
+            if (now >= next_step) {
+                // Update grid and team happiness by moving agents
+                move_grid(grid, copy, side_length, strength, move_counter_ptr, update_view, pyramid);
+                calculate_team_happiness(grid, side_length, team_happiness_ptr);
+                cycle_counter++;
+
+                // Schedule the next step, without catching up on missed ones
+                next_step += time;
+                if (next_step < now) {
+                    next_step = now + time;
+                }
+            }
         }
 
         endwin();
+        pyramid_destroy(pyramid);
     }
 
+    free(grid);
+    free(copy);
     return(EXIT_SUCCESS);
 }
\ No newline at end of file
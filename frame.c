@@ -0,0 +1,116 @@
+///
+/// File: frame.c
+/// Description: frame.c is a support file that implements the reusable output
+/// buffer for bracetopia simulations. Print mode builds each frame here and
+/// writes it out at once instead of issuing a stdio call per cell.
+///
+/// @author Adam Pang (akp4339@rit.edu)
+/// @date 02/23/2022
+// // // // // // // // // // // // // // // // // // // // // // // // // // //
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "frame.h"
+
+/**
+ * frame_reserve doubles the capacity of the frame until extra more bytes fit.
+ *
+ * @param frame: Pointer to the frame being grown
+ * @param extra: Number of bytes that will be appended
+ * @return char*: Pointer to the end of the frame, or NULL if allocation failed
+ */
+char *frame_reserve(FrameBuffer *frame, size_t extra) {
+    if (frame->length + extra > frame->capacity) {
+        size_t capacity = (frame->capacity > 0) ? frame->capacity : 256;
+        while (frame->length + extra > capacity) {
+            capacity *= 2;
+        }
+
+        char *data = realloc(frame->data, capacity);
+        if (data == NULL) {
+            return NULL;
+        }
+        frame->data = data;
+        frame->capacity = capacity;
+    }
+
+    return frame->data + frame->length;
+}
+
+/**
+ * frame_commit grows the length of the frame over bytes already written
+ * into space from frame_reserve.
+ *
+ * @param frame: Pointer to the frame being appended to
+ * @param count: Number of reserved bytes that were written
+ */
+void frame_commit(FrameBuffer *frame, size_t count) {
+    frame->length += count;
+}
+
+/**
+ * frame_printf formats text directly into the frame, growing it and
+ * formatting again if the text did not fit.
+ *
+ * @param frame: Pointer to the frame being appended to
+ * @param format: printf style format string
+ * @return int: Number of characters appended, or -1 on failure
+ */
+int frame_printf(FrameBuffer *frame, const char *format, ...) {
+    va_list args;
+    // Make sure the frame has storage to format into
+    if (frame_reserve(frame, 1) == NULL) {
+        return -1;
+    }
+    size_t available = frame->capacity - frame->length;
+
+    // Try formatting into the space already available
+    va_start(args, format);
+    int written = vsnprintf(frame->data + frame->length, available, format, args);
+    va_end(args);
+    if (written < 0) {
+        return -1;
+    }
+
+    // Grow the frame and format again if the text was truncated
+    if ((size_t) written >= available) {
+        if (frame_reserve(frame, (size_t) written + 1) == NULL) {
+            return -1;
+        }
+        va_start(args, format);
+        vsnprintf(frame->data + frame->length, (size_t) written + 1, format, args);
+        va_end(args);
+    }
+
+    frame_commit(frame, (size_t) written);
+    return written;
+}
+
+/**
+ * frame_flush writes the whole frame to stream with one fwrite and empties
+ * the frame while keeping its storage.
+ *
+ * @param frame: Pointer to the frame being written
+ * @param stream: Stream the frame is written to
+ * @return int: 0 on success, or -1 if the write failed
+ */
+int frame_flush(FrameBuffer *frame, FILE *stream) {
+    size_t written = fwrite(frame->data, 1, frame->length, stream);
+    int result = (written == frame->length) ? 0 : -1;
+
+    frame->length = 0;
+    return result;
+}
+
+/**
+ * frame_free frees the storage of the frame and resets it to empty.
+ *
+ * @param frame: Pointer to the frame being freed
+ */
+void frame_free(FrameBuffer *frame) {
+    free(frame->data);
+    frame->data = NULL;
+    frame->length = 0;
+    frame->capacity = 0;
+}
@@ -0,0 +1,70 @@
+///
+/// File: frame.h
+/// Description: frame.h is the interface for the reusable output buffer that
+/// each print mode frame of a bracetopia simulation is built in
+///
+/// @author Adam Pang (akp4339)
+/// @date 02/23/2022
+// // // // // // // // // // // // // // // // // // // // // // // // // // //
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * FrameBuffer holds the bytes of one output frame. The storage is kept
+ * between frames so it only grows until it fits the largest frame.
+ */
+typedef struct {
+    char *data;             // Bytes of the frame
+    size_t length;          // Number of bytes in use
+    size_t capacity;        // Number of bytes allocated
+} FrameBuffer;
+
+/**
+ * frame_reserve makes room for extra more bytes at the end of the frame.
+ * The bytes become part of the frame once passed to frame_commit.
+ *
+ * @param frame: Pointer to the frame being grown
+ * @param extra: Number of bytes that will be appended
+ * @return char*: Pointer to the end of the frame, or NULL if allocation failed
+ */
+char *frame_reserve(FrameBuffer *frame, size_t extra);
+
+/**
+ * frame_commit adds count bytes written through frame_reserve to the frame.
+ *
+ * @param frame: Pointer to the frame being appended to
+ * @param count: Number of reserved bytes that were written
+ */
+void frame_commit(FrameBuffer *frame, size_t count);
+
+/**
+ * frame_printf appends printf style formatted text to the frame.
+ *
+ * @param frame: Pointer to the frame being appended to
+ * @param format: printf style format string
+ * @return int: Number of characters appended, or -1 on failure
+ */
+int frame_printf(FrameBuffer *frame, const char *format, ...);
+
+/**
+ * frame_flush writes the whole frame to stream in a single call and empties
+ * the frame for reuse.
+ *
+ * @param frame: Pointer to the frame being written
+ * @param stream: Stream the frame is written to
+ * @return int: 0 on success, or -1 if the write failed
+ */
+int frame_flush(FrameBuffer *frame, FILE *stream);
+
+/**
+ * frame_free frees the storage of the frame.
+ *
+ * @param frame: Pointer to the frame being freed
+ */
+void frame_free(FrameBuffer *frame);
+
+#endif // FRAME_H
@@ -8,12 +8,13 @@
 // // // // // // // // // // // // // // // // // // // // // // // // // // //
 
 #define _DEFAULT_SOURCE_      // Required to use random and usleep
-#include <ncurses.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
 #include "agent.h"
+#include "frame.h"
+#include "grid.h"
 
 /**
  * random_int is a function that is called from initialize_grid to help
@@ -76,42 +77,70 @@ void initialize_grid(char *grid, int size, int vacancy, int endlines) {
 }
 
 /**
- * output_print_grid accepts a pointer to a particular grid in a bracetopia
- * simulation and outputs the grid as a 2d array. Used for print mode display
+ * output_print_grid appends a particular grid in a bracetopia simulation to
+ * the frame as a 2d array of text. Used for print mode display
  * 
+ * @param frame: Pointer to the frame the grid is appended to
  * @param grid: Pointer that points to the actual 1d array grid
  * @param side_length: Integer representing the side length of the 2d square grid
+ * @return int: 0 on success, or -1 if the frame could not grow (frame unchanged)
  */
-void output_print_grid(char *grid, int side_length) {
+int output_print_grid(FrameBuffer *frame, char *grid, int side_length) {
+    // Each row is a newline followed by a character and space per cell
+    const size_t ROW_BYTES = 1 + 2 * (size_t) side_length;
+    char *out = frame_reserve(frame, ROW_BYTES * side_length);
+    if (out == NULL) {
+        return -1;
+    }
+
     // Cycle through all elements in grid
-    for (int i = 0; i < side_length * side_length; i++) {
-        // If multiple of side_length, output newline for 2d display
-        if ((i != side_length * side_length - 1) && (i % side_length == 0)) {
-            printf("\n");
+    for (int row = 0; row < side_length; row++) {
+        // Output newline for 2d display
+        *out++ = '\n';
+        for (int col = 0; col < side_length; col++) {
+            // Output character from grid
+            *out++ = grid[(row * side_length) + col];
+            *out++ = ' ';
         }
-        // Output character from grid
-        printf("%c ", grid[i]);
     }
+    frame_commit(frame, ROW_BYTES * side_length);
+    return 0;
 }
 
 /**
- * output_ngrid accepts a pointer to a particular grid in a bracetopia
- * simulation and outputs the grid as a 2d array. Used for ncurses 
- * display.
+ * output_pgm_grid appends a particular grid in a bracetopia simulation to
+ * the frame as a binary PGM image with one byte per cell: endlines are
+ * white, newlines are black, and vacancies are gray.
  * 
+ * @param frame: Pointer to the frame the grid is appended to
  * @param grid: Pointer that points to the actual 1d array grid
  * @param side_length: Integer representing the side length of the 2d square grid
+ * @return int: 0 on success, or -1 if the frame could not grow (frame unchanged)
  */
-void output_ngrid(char *grid, int side_length) {
+int output_pgm_grid(FrameBuffer *frame, char *grid, int side_length) {
+    const size_t NUM_ELEMENTS = (size_t) side_length * side_length;
+    char header[64];
+    // Map each agent character to its gray level
+    unsigned char shades[256] = { 0 };
+    shades['e'] = 255;
+    shades['.'] = 128;
+    shades['n'] = 0;
+
+    // Reserve header and pixels together so a failure leaves no partial image
+    int header_length = snprintf(header, sizeof(header), "P5\n%d %d\n255\n", side_length, side_length);
+    unsigned char *out = (unsigned char *) frame_reserve(frame, header_length + NUM_ELEMENTS);
+    if (out == NULL) {
+        return -1;
+    }
+    memcpy(out, header, header_length);
+    out += header_length;
+
     // Cycle through all elements in grid
-    for (int i = 0; i < side_length * side_length; i++) {
-        // If multiple of side_length, output newline for 2d display
-        if (i % side_length == 0) {
-            printw("\n");
-        }
-        // Output character from grid
-        printw("%c ", grid[i]);
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        out[i] = shades[(unsigned char) grid[i]];
     }
+    frame_commit(frame, header_length + NUM_ELEMENTS);
+    return 0;
 }
 
 /**
@@ -119,20 +148,23 @@ void output_ngrid(char *grid, int side_length) {
  * and relocates them to the next vacant spot in the current grid
  * 
  * @param grid: Pointer that points to a character array
+ * @param copy: Pointer to a scratch character array the size of grid
  * @param side_length: Integer representing the side length of the 2d square grid
  * @param threshold: Integer minimum required for an agent to not move
  * @param move_counter: Pointer to retrieve number of agents relocated
+ * @param on_move: Function called for each relocation, or NULL
+ * @param context: Pointer passed through to on_move
  */
-void move_grid(char *grid, int side_length, int threshold, int *move_counter) {
+void move_grid(char *grid, char *copy, int side_length, int threshold, int *move_counter,
+        relocation_callback on_move, void *context) {
     // Set up variables for counting
     const int NUM_ELEMENTS = side_length * side_length;
-    // Create copy grid to hold information for comparisons
-    char copy[NUM_ELEMENTS];
-    strcpy(copy, grid);
+    // Fill copy grid to hold information for comparisons
+    memcpy(copy, grid, NUM_ELEMENTS);
     // Initialize variables
     int next_vacant = 0;
     double threshold_percent = (double) threshold / 100;
-    char neighbors[NUM_ELEMENTS];
+    char neighbors[8];
     // Reset move_counter for new move grid
     *move_counter = 0;
 
@@ -171,10 +203,14 @@ void move_grid(char *grid, int side_length, int threshold, int *move_counter) {
 
                 // If next_vacant is truly vacant, perform relocation
                 // Fixes issue with next_vacant at final element
-                if (copy[next_vacant] == '.') {
+                if (next_vacant < NUM_ELEMENTS && copy[next_vacant] == '.') {
                     // Swap agents and vacant
                     grid[unhappy_check] = '.';
                     grid[next_vacant] = copy[unhappy_check];
+                    // Report relocation to the caller
+                    if (on_move != NULL) {
+                        on_move(unhappy_check, next_vacant, copy[unhappy_check], context);
+                    }
                     // Increment counters
                     next_vacant++;
                     *move_counter = *move_counter + 1;
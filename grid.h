@@ -10,6 +10,19 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include "frame.h"
+
+/**
+ * relocation_callback is called by move_grid for each agent it relocates,
+ * so callers can track changes without rescanning the grid.
+ * 
+ * @param from: Integer location the agent left within the 1d grid
+ * @param to: Integer location the agent moved to within the 1d grid
+ * @param agent: Character of the agent that moved
+ * @param context: Pointer passed through from move_grid
+ */
+typedef void (*relocation_callback)(int from, int to, char agent, void *context);
+
 /**
  * random_int is a static function that is called from initialize_grid to help
  * with the Fisher-Yates shuffling algorithm.
@@ -32,35 +45,42 @@ int random_int(int min, int max);
 void initialize_grid(char *grid, int size, int vacancy, int endlines);
 
 /**
- * output_print_grid accepts a pointer to a particular character array and outputs 
- * its contents in the form of a 2d array (assuming square). Used for print
+ * output_print_grid appends the contents of a particular character array to
+ * the frame in the form of a 2d array (assuming square). Used for print
  * mode display
  * 
+ * @param frame: Pointer to the frame the grid is appended to
  * @param grid: Pointer that points to a character array
  * @param side_length: Integer of width/height for the 2d display
+ * @return int: 0 on success, or -1 if the frame could not grow
  */
-void output_print_grid(char *grid, int side_length);
-
+int output_print_grid(FrameBuffer *frame, char *grid, int side_length);
 
 /**
- * output_ngrid accepts a pointer to a particular character array and outputs 
- * its contents in the form of a 2d array (assuming square). Used for ncurses
- * display.
+ * output_pgm_grid appends the contents of a particular character array to
+ * the frame as a binary PGM image (assuming square). Used for print mode
+ * display in pgm format
  * 
+ * @param frame: Pointer to the frame the grid is appended to
  * @param grid: Pointer that points to a character array
- * @param side_length: Integer of width/height for the 2d display
+ * @param side_length: Integer of width/height of the image
+ * @return int: 0 on success, or -1 if the frame could not grow
  */
-void output_ngrid(char *grid, int side_length);
+int output_pgm_grid(FrameBuffer *frame, char *grid, int side_length);
 
 /**
  * move_grid utilizes move logic to move the first founded unhappy agents
  * and relocates them to the next vacant spot in the current grid
  * 
  * @param grid: Pointer that points to a character array
+ * @param copy: Pointer to a scratch character array the size of grid
  * @param side_length: Integer representing the side length of the 2d square grid
  * @param threshold: Integer minimum required for an agent to not move
  * @param move_counter: Pointer to retrieve number of agents relocated
+ * @param on_move: Function called for each relocation, or NULL
+ * @param context: Pointer passed through to on_move
  */
-void move_grid(char *grid, int side_length, int threshold, int *move_counter);
+void move_grid(char *grid, char *copy, int side_length, int threshold, int *move_counter,
+        relocation_callback on_move, void *context);
 
 #endif // GRID_H
\ No newline at end of file
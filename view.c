@@ -0,0 +1,316 @@
+///
+/// File: view.c
+/// Description: view.c is a support file that implements the zoomable ncurses
+/// viewport for bracetopia simulations. Zoomed out views are drawn from a
+/// pyramid of block counts that is updated as agents relocate, so redrawing
+/// never rescans the board.
+///
+/// @author Adam Pang (akp4339@rit.edu)
+/// @date 02/23/2022
+// // // // // // // // // // // // // // // // // // // // // // // // // // //
+
+#define _DEFAULT_SOURCE_
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "view.h"
+
+/**
+ * pyramid_create allocates the block counts of every level and builds each
+ * level from the one below it.
+ *
+ * @param grid: Pointer that points to the actual 1d array grid
+ * @param side_length: Integer representing the side length of the 2d square grid
+ * @return Pyramid*: Newly allocated pyramid, or NULL if allocation failed
+ */
+Pyramid *pyramid_create(char *grid, int side_length) {
+    Pyramid *pyramid = calloc(1, sizeof(Pyramid));
+    if (pyramid == NULL) {
+        return NULL;
+    }
+    pyramid->grid = grid;
+    pyramid->side_length = side_length;
+
+    // Count levels until a single block covers the whole grid
+    pyramid->levels = 1;
+    for (int dim = side_length; dim > 1; dim = (dim + 1) / 2) {
+        pyramid->levels++;
+    }
+
+    pyramid->dims = calloc(pyramid->levels, sizeof(int));
+    pyramid->endline_counts = calloc(pyramid->levels, sizeof(int *));
+    pyramid->newline_counts = calloc(pyramid->levels, sizeof(int *));
+    if (pyramid->dims == NULL || pyramid->endline_counts == NULL || pyramid->newline_counts == NULL) {
+        pyramid_destroy(pyramid);
+        return NULL;
+    }
+    pyramid->dims[0] = side_length;
+
+    for (int level = 1; level < pyramid->levels; level++) {
+        // Each block of this level covers up to 2x2 blocks of the level below
+        const int dim = (pyramid->dims[level - 1] + 1) / 2;
+        const int below = pyramid->dims[level - 1];
+        pyramid->dims[level] = dim;
+        pyramid->endline_counts[level] = calloc((size_t) dim * dim, sizeof(int));
+        pyramid->newline_counts[level] = calloc((size_t) dim * dim, sizeof(int));
+        if (pyramid->endline_counts[level] == NULL || pyramid->newline_counts[level] == NULL) {
+            pyramid_destroy(pyramid);
+            return NULL;
+        }
+
+        for (int row = 0; row < below; row++) {
+            for (int col = 0; col < below; col++) {
+                int block = (row / 2) * dim + (col / 2);
+                int child = row * below + col;
+
+                if (level == 1) {
+                    // Level 1 is counted directly from the grid
+                    if (grid[child] == 'e') {
+                        pyramid->endline_counts[level][block]++;
+                    }
+                    else if (grid[child] == 'n') {
+                        pyramid->newline_counts[level][block]++;
+                    }
+                }
+                else {
+                    pyramid->endline_counts[level][block] += pyramid->endline_counts[level - 1][child];
+                    pyramid->newline_counts[level][block] += pyramid->newline_counts[level - 1][child];
+                }
+            }
+        }
+    }
+
+    return pyramid;
+}
+
+/**
+ * pyramid_destroy frees the block counts and the pyramid itself. The grid is
+ * owned by the caller and is left untouched.
+ *
+ * @param pyramid: Pointer to the pyramid being freed
+ */
+void pyramid_destroy(Pyramid *pyramid) {
+    if (pyramid == NULL) {
+        return;
+    }
+
+    for (int level = 0; level < pyramid->levels; level++) {
+        if (pyramid->endline_counts != NULL) {
+            free(pyramid->endline_counts[level]);
+        }
+        if (pyramid->newline_counts != NULL) {
+            free(pyramid->newline_counts[level]);
+        }
+    }
+    free(pyramid->endline_counts);
+    free(pyramid->newline_counts);
+    free(pyramid->dims);
+    free(pyramid);
+}
+
+/**
+ * pyramid_update moves one count from old_agent to new_agent in the block
+ * containing index on every level above the grid.
+ *
+ * @param pyramid: Pointer to the pyramid being updated
+ * @param index: Integer location of the changed cell within the 1d grid
+ * @param old_agent: Character previously held by the cell
+ * @param new_agent: Character now held by the cell
+ */
+void pyramid_update(Pyramid *pyramid, int index, char old_agent, char new_agent) {
+    int row = index / pyramid->side_length;
+    int col = index % pyramid->side_length;
+
+    for (int level = 1; level < pyramid->levels; level++) {
+        int block = (row >> level) * pyramid->dims[level] + (col >> level);
+
+        if (old_agent == 'e') {
+            pyramid->endline_counts[level][block]--;
+        }
+        else if (old_agent == 'n') {
+            pyramid->newline_counts[level][block]--;
+        }
+        if (new_agent == 'e') {
+            pyramid->endline_counts[level][block]++;
+        }
+        else if (new_agent == 'n') {
+            pyramid->newline_counts[level][block]++;
+        }
+    }
+}
+
+/**
+ * pyramid_summary returns the majority agent of a block, '=' if both teams
+ * are tied, or '.' if the block has no agents.
+ *
+ * @param pyramid: Pointer to the pyramid being read
+ * @param level: Integer level of the block
+ * @param row: Integer row of the block within the level
+ * @param col: Integer column of the block within the level
+ * @return char: Summary character of the block
+ */
+char pyramid_summary(Pyramid *pyramid, int level, int row, int col) {
+    int block = row * pyramid->dims[level] + col;
+
+    // Level 0 blocks are single cells
+    if (level == 0) {
+        return pyramid->grid[block];
+    }
+
+    int endline = pyramid->endline_counts[level][block];
+    int newline = pyramid->newline_counts[level][block];
+    if (endline == 0 && newline == 0) {
+        return '.';
+    }
+    else if (endline > newline) {
+        return 'e';
+    }
+    else if (newline > endline) {
+        return 'n';
+    }
+    return '=';
+}
+
+/**
+ * clamp_view keeps the viewport aligned to whole blocks of its zoom level
+ * and inside the edges of the grid.
+ *
+ * @param view: Pointer to the viewport being clamped
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ */
+static void clamp_view(Viewport *view, Pyramid *pyramid, int rows, int cols) {
+    const int dim = pyramid->dims[view->zoom];
+    // Each block is displayed as a character followed by a space
+    int max_top = dim - rows;
+    int max_left = dim - (cols / 2);
+    int top = view->top >> view->zoom;
+    int left = view->left >> view->zoom;
+
+    if (top > max_top) {
+        top = max_top;
+    }
+    if (left > max_left) {
+        left = max_left;
+    }
+    if (top < 0) {
+        top = 0;
+    }
+    if (left < 0) {
+        left = 0;
+    }
+
+    view->top = top << view->zoom;
+    view->left = left << view->zoom;
+}
+
+/**
+ * view_fit picks the lowest zoom level whose blocks fit within the screen
+ * and shows the grid from its top left corner.
+ *
+ * @param view: Pointer to the viewport being initialized
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ */
+void view_fit(Viewport *view, Pyramid *pyramid, int rows, int cols) {
+    view->zoom = 0;
+    view->top = 0;
+    view->left = 0;
+
+    while (view->zoom < pyramid->levels - 1) {
+        const int dim = pyramid->dims[view->zoom];
+        if (dim <= rows && dim <= cols / 2) {
+            break;
+        }
+        view->zoom++;
+    }
+}
+
+/**
+ * view_handle_key pans by half a screen with the arrow keys or hjkl, and
+ * zooms in or out with '+' or '-' while keeping the center of the view fixed.
+ *
+ * @param view: Pointer to the viewport being changed
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param key: Integer key code returned by getch
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ */
+void view_handle_key(Viewport *view, Pyramid *pyramid, int key, int rows, int cols) {
+    // Compute half a screen worth of cells, at least one block
+    int row_step = ((rows / 2) > 0 ? (rows / 2) : 1) << view->zoom;
+    int col_step = ((cols / 4) > 0 ? (cols / 4) : 1) << view->zoom;
+    int center_row = view->top + ((rows << view->zoom) / 2);
+    int center_col = view->left + (((cols / 2) << view->zoom) / 2);
+
+    switch (key) {
+    case KEY_UP:
+    case 'k':
+        view->top -= row_step;
+        break;
+    case KEY_DOWN:
+    case 'j':
+        view->top += row_step;
+        break;
+    case KEY_LEFT:
+    case 'h':
+        view->left -= col_step;
+        break;
+    case KEY_RIGHT:
+    case 'l':
+        view->left += col_step;
+        break;
+    case '+':
+    case '=':
+        if (view->zoom > 0) {
+            view->zoom--;
+        }
+        view->top = center_row - ((rows << view->zoom) / 2);
+        view->left = center_col - (((cols / 2) << view->zoom) / 2);
+        break;
+    case '-':
+    case '_':
+        if (view->zoom < pyramid->levels - 1) {
+            view->zoom++;
+        }
+        view->top = center_row - ((rows << view->zoom) / 2);
+        view->left = center_col - (((cols / 2) << view->zoom) / 2);
+        break;
+    default:
+        break;
+    }
+
+    clamp_view(view, pyramid, rows, cols);
+}
+
+/**
+ * output_nview outputs the blocks of the current zoom level that fall inside
+ * the viewport, starting on the second screen row. Used for ncurses display.
+ *
+ * @param view: Pointer to the viewport being displayed
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ * @return int: Number of screen rows used by the grid
+ */
+int output_nview(Viewport *view, Pyramid *pyramid, int rows, int cols) {
+    const int dim = pyramid->dims[view->zoom];
+    int top = view->top >> view->zoom;
+    int left = view->left >> view->zoom;
+    int shown_rows = (dim - top < rows) ? (dim - top) : rows;
+    int shown_cols = (dim - left < cols / 2) ? (dim - left) : (cols / 2);
+
+    // Cycle through all visible blocks
+    for (int row = 0; row < shown_rows; row++) {
+        move(row + 1, 0);
+        for (int col = 0; col < shown_cols; col++) {
+            // Output summary character of block
+            addch(pyramid_summary(pyramid, view->zoom, top + row, left + col));
+            addch(' ');
+        }
+    }
+
+    return shown_rows;
+}
@@ -0,0 +1,109 @@
+///
+/// File: view.h
+/// Description: view.h is the interface for the zoomable ncurses viewport and
+/// the summary pyramid of block counts that backs it in a bracetopia simulation
+///
+/// @author Adam Pang (akp4339)
+/// @date 02/23/2022
+// // // // // // // // // // // // // // // // // // // // // // // // // // //
+
+#ifndef VIEW_H
+#define VIEW_H
+
+/**
+ * Pyramid holds the per-block agent counts of a grid at every zoom level.
+ * Level 0 is the grid itself; level k summarizes 2^k by 2^k blocks of cells.
+ */
+typedef struct {
+    char *grid;             // Grid being summarized (level 0)
+    int side_length;        // Width/height of the grid
+    int levels;             // Number of levels including level 0
+    int *dims;              // Width/height of each level
+    int **endline_counts;   // Endline agents per block (unused for level 0)
+    int **newline_counts;   // Newline agents per block (unused for level 0)
+} Pyramid;
+
+/**
+ * Viewport holds the current zoom level and the top left cell of the
+ * visible portion of the grid.
+ */
+typedef struct {
+    int zoom;               // Pyramid level being displayed
+    int top;                // Row of the top left cell shown
+    int left;               // Column of the top left cell shown
+} Viewport;
+
+/**
+ * pyramid_create allocates and builds the summary pyramid for a grid.
+ *
+ * @param grid: Pointer that points to a character array
+ * @param side_length: Integer representing the side length of the 2d square grid
+ * @return Pyramid*: Newly allocated pyramid, or NULL if allocation failed
+ */
+Pyramid *pyramid_create(char *grid, int side_length);
+
+/**
+ * pyramid_destroy frees all memory owned by a pyramid (not the grid).
+ *
+ * @param pyramid: Pointer to the pyramid being freed
+ */
+void pyramid_destroy(Pyramid *pyramid);
+
+/**
+ * pyramid_update adjusts the block counts of every level after the cell at
+ * index changed from old_agent to new_agent.
+ *
+ * @param pyramid: Pointer to the pyramid being updated
+ * @param index: Integer location of the changed cell within the 1d grid
+ * @param old_agent: Character previously held by the cell
+ * @param new_agent: Character now held by the cell
+ */
+void pyramid_update(Pyramid *pyramid, int index, char old_agent, char new_agent);
+
+/**
+ * pyramid_summary returns the character summarizing one block of a level:
+ * the majority agent, '=' for a tie, or '.' for an empty block.
+ *
+ * @param pyramid: Pointer to the pyramid being read
+ * @param level: Integer level of the block
+ * @param row: Integer row of the block within the level
+ * @param col: Integer column of the block within the level
+ * @return char: Summary character of the block
+ */
+char pyramid_summary(Pyramid *pyramid, int level, int row, int col);
+
+/**
+ * view_fit initializes a viewport at the closest zoom level that shows the
+ * whole grid within rows by cols screen characters.
+ *
+ * @param view: Pointer to the viewport being initialized
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ */
+void view_fit(Viewport *view, Pyramid *pyramid, int rows, int cols);
+
+/**
+ * view_handle_key pans or zooms the viewport in response to a key press.
+ *
+ * @param view: Pointer to the viewport being changed
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param key: Integer key code returned by getch
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ */
+void view_handle_key(Viewport *view, Pyramid *pyramid, int key, int rows, int cols);
+
+/**
+ * output_nview outputs the portion of the grid inside the viewport, one
+ * block summary per screen cell. Used for ncurses display.
+ *
+ * @param view: Pointer to the viewport being displayed
+ * @param pyramid: Pointer to the pyramid being displayed
+ * @param rows: Integer number of screen rows available for the grid
+ * @param cols: Integer number of screen columns available for the grid
+ * @return int: Number of screen rows used by the grid
+ */
+int output_nview(Viewport *view, Pyramid *pyramid, int rows, int cols);
+
+#endif // VIEW_H